@@ -0,0 +1,201 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of Sprocket real-time scheduler.
+GitHub : https://github.com/SwatKat1977/sprocketRealtimeScheduler
+
+Copyright 2024 Sprocket real-time scheduler Development Team
+
+    This program is free software : you can redistribute it and /or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see < https://www.gnu.org/licenses/>.
+-----------------------------------------------------------------------------
+*/
+#include "AllocationGuard.h"
+#include "Constants.h"
+
+#if defined(SPROCKET_TRAP_RT_ALLOCATIONS)
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace sprocketRealtimeScheduler {
+
+// Initial-exec TLS so reading it from malloc() can never itself allocate.
+#if defined(__GNUC__)
+static thread_local bool allocations_trapped_
+    __attribute__((tls_model("initial-exec"))) = false;
+#else
+static thread_local bool allocations_trapped_ = false;
+#endif
+
+RealtimeAllocationGuard::RealtimeAllocationGuard()
+    : previous_(allocations_trapped_) {
+    allocations_trapped_ = true;
+}
+
+RealtimeAllocationGuard::~RealtimeAllocationGuard() {
+    allocations_trapped_ = previous_;
+}
+
+bool RealtimeAllocationGuard::IsActive() {
+    return allocations_trapped_;
+}
+
+static void TrapAllocation(const char *operation) {
+    if (!allocations_trapped_) return;
+
+    // Disarm first, writing the message must not trap again.
+    allocations_trapped_ = false;
+    std::fprintf(stderr, "heap %s on a real-time thread\n", operation);
+    std::abort();
+}
+
+}   // namespace sprocketRealtimeScheduler
+
+void *operator new(std::size_t size) {
+    sprocketRealtimeScheduler::TrapAllocation("allocation");
+
+    void *memory = std::malloc(size ? size : 1);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void *operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    sprocketRealtimeScheduler::TrapAllocation("allocation");
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void *memory) noexcept {
+    if (memory) sprocketRealtimeScheduler::TrapAllocation("free");
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    ::operator delete(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    ::operator delete(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept {
+    ::operator delete(memory);
+}
+
+#if defined(__GLIBC__)
+// glibc's own allocator entry points, used to forward the interposed C
+// allocation functions.
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *memory, std::size_t size);
+void __libc_free(void *memory);
+
+void *malloc(std::size_t size) {
+    sprocketRealtimeScheduler::TrapAllocation("allocation");
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size) {
+    sprocketRealtimeScheduler::TrapAllocation("allocation");
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *memory, std::size_t size) {
+    sprocketRealtimeScheduler::TrapAllocation("allocation");
+    return __libc_realloc(memory, size);
+}
+
+void free(void *memory) {
+    if (memory) sprocketRealtimeScheduler::TrapAllocation("free");
+    __libc_free(memory);
+}
+}   // extern "C"
+#endif  // __GLIBC__
+
+#if defined(__cpp_aligned_new)
+namespace sprocketRealtimeScheduler {
+
+static void *AlignedAllocate(std::size_t size, std::align_val_t alignment) {
+    TrapAllocation("allocation");
+
+    size_t align = static_cast<size_t>(alignment);
+    if (align < sizeof(void *)) align = sizeof(void *);
+
+#if (PLATFORM_TYPE == PLATFORM_LINUX)
+    void *memory = nullptr;
+    if (posix_memalign(&memory, align, size ? size : 1) != 0) return nullptr;
+    return memory;
+#else
+    return _aligned_malloc(size ? size : 1, align);
+#endif
+}
+
+static void AlignedFree(void *memory) {
+    if (memory) TrapAllocation("free");
+
+#if (PLATFORM_TYPE == PLATFORM_LINUX)
+    std::free(memory);
+#else
+    _aligned_free(memory);
+#endif
+}
+
+}   // namespace sprocketRealtimeScheduler
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    void *memory = sprocketRealtimeScheduler::AlignedAllocate(size, alignment);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+    return sprocketRealtimeScheduler::AlignedAllocate(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+    return sprocketRealtimeScheduler::AlignedAllocate(size, alignment);
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept {
+    sprocketRealtimeScheduler::AlignedFree(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t) noexcept {
+    sprocketRealtimeScheduler::AlignedFree(memory);
+}
+
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept {
+    sprocketRealtimeScheduler::AlignedFree(memory);
+}
+
+void operator delete[](void *memory, std::size_t,
+                       std::align_val_t) noexcept {
+    sprocketRealtimeScheduler::AlignedFree(memory);
+}
+#endif  // __cpp_aligned_new
+
+#endif  // SPROCKET_TRAP_RT_ALLOCATIONS
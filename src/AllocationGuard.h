@@ -0,0 +1,68 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of Sprocket real-time scheduler.
+GitHub : https://github.com/SwatKat1977/sprocketRealtimeScheduler
+
+Copyright 2024 Sprocket real-time scheduler Development Team
+
+    This program is free software : you can redistribute it and /or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see < https://www.gnu.org/licenses/>.
+-----------------------------------------------------------------------------
+*/
+#ifndef ALLOCATIONGUARD_H_
+#define ALLOCATIONGUARD_H_
+
+namespace sprocketRealtimeScheduler {
+
+//  Debug aid to catch heap activity on a real-time thread.  When built with
+//  SPROCKET_TRAP_RT_ALLOCATIONS the global operator new/delete are replaced
+//  and any call made while a guard is alive on the calling thread aborts the
+//  process, so the offending call stack can be found in the core dump.
+//
+//  All forms of operator new/delete are trapped.  With glibc malloc(),
+//  calloc(), realloc() and free() are also interposed, which catches C
+//  library allocations and exception objects (allocated with malloc by the
+//  C++ runtime); on other platforms those go untrapped.
+//
+//  Without SPROCKET_TRAP_RT_ALLOCATIONS the guard is empty and costs nothing.
+#if defined(SPROCKET_TRAP_RT_ALLOCATIONS)
+class RealtimeAllocationGuard {
+ public:
+    RealtimeAllocationGuard();
+    ~RealtimeAllocationGuard();
+
+    RealtimeAllocationGuard(const RealtimeAllocationGuard &) = delete;
+    RealtimeAllocationGuard &operator=(
+        const RealtimeAllocationGuard &) = delete;
+
+    static bool IsActive();
+
+ private:
+    bool previous_;
+};
+#else
+class RealtimeAllocationGuard {
+ public:
+    RealtimeAllocationGuard() {}
+
+    RealtimeAllocationGuard(const RealtimeAllocationGuard &) = delete;
+    RealtimeAllocationGuard &operator=(
+        const RealtimeAllocationGuard &) = delete;
+
+    static bool IsActive() { return false; }
+};
+#endif
+
+}   // namespace sprocketRealtimeScheduler
+
+#endif  // ALLOCATIONGUARD_H_
@@ -0,0 +1,233 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of Sprocket real-time scheduler.
+GitHub : https://github.com/SwatKat1977/sprocketRealtimeScheduler
+
+Copyright 2024 Sprocket real-time scheduler Development Team
+
+    This program is free software : you can redistribute it and /or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see < https://www.gnu.org/licenses/>.
+-----------------------------------------------------------------------------
+*/
+#include <stdexcept>
+#include "BackgroundWork.h"
+#include "ThreadCondition.h"
+
+#if (PLATFORM_TYPE == PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#else
+#include <windows.h>
+#endif
+
+namespace sprocketRealtimeScheduler {
+
+// How long an idle background worker sleeps before polling again.
+constexpr timeout_usecs BACKGROUND_POLL_INTERVAL = timeout_usecs(500);
+
+BackgroundChannel::BackgroundChannel() : pending_count_(0) {
+    ZeroStatistics();
+}
+
+bool BackgroundChannel::Submit(const BackgroundWorkItem &item) {
+    DWORD submitted = submitted_.load(std::memory_order_relaxed);
+    DWORD in_flight = submitted - delivered_.load(std::memory_order_relaxed);
+
+    // This runs on the realtime thread, so an invalid delivery frame is
+    // rejected rather than thrown (which would allocate).
+    bool invalid_frame = item.delivery_frame_ >= MAX_FRAMES &&
+                         item.delivery_frame_ != DELIVER_NEXT_FRAME;
+
+    if (invalid_frame || in_flight >= BACKGROUND_QUEUE_SIZE) {
+        dropped_.store(dropped_.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_release);
+        return false;
+    }
+
+    // Count the item before it becomes visible to the worker, so started_
+    // can never get ahead of submitted_.  The push can't fail as fewer than
+    // BACKGROUND_QUEUE_SIZE items are in flight.
+    submitted_.store(submitted + 1, std::memory_order_release);
+    submissions_.Push(item);
+
+    if (in_flight + 1 > worst_in_flight_.load(std::memory_order_relaxed)) {
+        worst_in_flight_.store(in_flight + 1, std::memory_order_relaxed);
+    }
+
+    return true;
+}
+
+DWORD BackgroundChannel::DeliverCompletions(DWORD major_frame,
+                                            DWORD current_frame) {
+    // This runs on the realtime thread, so don't throw (which would allocate).
+    if (current_frame >= MAX_FRAMES) return 0;
+
+    // Frames are compared as an absolute count of minor frames.
+    uint64_t now = static_cast<uint64_t>(major_frame) * MAX_FRAMES +
+                   current_frame;
+    BackgroundWorkItem item;
+    DWORD delivered = 0;
+
+    // Move finished items off the ring, there is always room for them as no
+    // more than BACKGROUND_QUEUE_SIZE items can be in flight.  Each is due
+    // on the next occurrence of its delivery frame.
+    while (completions_.Pop(item)) {
+        uint64_t due = now;
+
+        if (item.delivery_frame_ != DELIVER_NEXT_FRAME) {
+            due = now - current_frame + item.delivery_frame_;
+            if (item.delivery_frame_ < current_frame) due += MAX_FRAMES;
+        }
+
+        pending_due_[pending_count_] = due;
+        pending_[pending_count_++] = item;
+    }
+
+    DWORD idx = 0;
+    while (idx < pending_count_) {
+        if (pending_due_[idx] > now) {
+            idx++;
+            continue;
+        }
+
+        BackgroundWorkItem &entry = pending_[idx];
+        if (entry.completion_) entry.completion_(entry);
+        delivered++;
+
+        // Keep the pending list packed, order isn't important.
+        pending_count_--;
+        pending_[idx] = pending_[pending_count_];
+        pending_due_[idx] = pending_due_[pending_count_];
+    }
+
+    if (delivered) {
+        delivered_.store(delivered_.load(std::memory_order_relaxed) +
+                         delivered, std::memory_order_release);
+    }
+
+    return delivered;
+}
+
+BackgroundWorkStatistics BackgroundChannel::GetStatistics() {
+    BackgroundWorkStatistics stats;
+
+    // Load the counters that trail submitted_ first, otherwise an item
+    // submitted and started between the loads could make them overtake a
+    // stale submitted_ and wrap the differences below.
+    DWORD started = started_.load(std::memory_order_acquire);
+    stats.delivered_ = delivered_.load(std::memory_order_acquire);
+    stats.submitted_ = submitted_.load(std::memory_order_acquire);
+    stats.dropped_ = dropped_.load(std::memory_order_acquire);
+    stats.worst_in_flight_ = worst_in_flight_.load(std::memory_order_acquire);
+
+    stats.queued_ = stats.submitted_ - started;
+    stats.in_flight_ = stats.submitted_ - stats.delivered_;
+    return stats;
+}
+
+/*
+Counters are relative to each other, so this should only be called before the
+realtime thread starts submitting work.
+*/
+void BackgroundChannel::ZeroStatistics() {
+    submitted_.store(0);
+    dropped_.store(0);
+    delivered_.store(0);
+    worst_in_flight_.store(0);
+    started_.store(0);
+}
+
+bool BackgroundChannel::RunPendingWork() {
+    BackgroundWorkItem item;
+
+    if (!submissions_.Pop(item)) return false;
+
+    started_.store(started_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_release);
+
+    if (item.work_) item.work_(item);
+
+    // Items are always handed back so that the realtime thread alone decides
+    // when an item is no longer in flight.
+    completions_.Push(item);
+    return true;
+}
+
+BackgroundWorkerPool::BackgroundWorkerPool(unsigned int worker_count) :
+    channels_(), channel_count_(0), worker_count_(worker_count),
+    running_(false) {
+    if (worker_count_ == 0) throw std::runtime_error("invalid worker count");
+}
+
+BackgroundWorkerPool::~BackgroundWorkerPool() {
+    Stop();
+}
+
+void BackgroundWorkerPool::AddChannel(BackgroundChannel *channel) {
+    if (running_.load()) throw std::runtime_error("worker pool is running");
+    if (channel_count_ >= MAX_BACKGROUND_CHANNELS) {
+        throw std::runtime_error("too many background channels");
+    }
+
+    channels_[channel_count_++] = channel;
+}
+
+void BackgroundWorkerPool::Start() {
+    if (running_.exchange(true)) return;
+
+    for (unsigned int idx = 0; idx < worker_count_; idx++) {
+        workers_.emplace_back(&BackgroundWorkerPool::WorkerLoop, this, idx);
+    }
+}
+
+void BackgroundWorkerPool::Stop() {
+    running_.store(false);
+
+    for (auto &worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+
+    workers_.clear();
+}
+
+void BackgroundWorkerPool::WorkerLoop(unsigned int worker) {
+    LowerPriority();
+
+    while (running_.load()) {
+        bool did_work = false;
+
+        // Channels are shared out between workers round robin.
+        for (unsigned int idx = worker; idx < channel_count_;
+             idx += worker_count_) {
+            while (channels_[idx]->RunPendingWork()) did_work = true;
+        }
+
+        if (!did_work) std::this_thread::sleep_for(BACKGROUND_POLL_INTERVAL);
+    }
+}
+
+/*
+Background workers must never compete with realtime threads, failing to lower
+the priority isn't fatal as they already run under the default policy.
+*/
+void BackgroundWorkerPool::LowerPriority() {
+#if (PLATFORM_TYPE == PLATFORM_LINUX)
+    sched_param param = {};
+    param.sched_priority = 0;
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#else
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#endif
+}
+
+}   // namespace sprocketRealtimeScheduler
@@ -0,0 +1,161 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of Sprocket real-time scheduler.
+GitHub : https://github.com/SwatKat1977/sprocketRealtimeScheduler
+
+Copyright 2024 Sprocket real-time scheduler Development Team
+
+    This program is free software : you can redistribute it and /or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see < https://www.gnu.org/licenses/>.
+-----------------------------------------------------------------------------
+*/
+#ifndef BACKGROUNDWORK_H_
+#define BACKGROUNDWORK_H_
+#include <atomic>
+#include <cstdint>
+#include <thread>               // NOLINT
+#include <type_traits>
+#include <vector>
+#include "Constants.h"
+#include "SpscRing.h"
+
+namespace sprocketRealtimeScheduler {
+
+struct BackgroundWorkItem;
+
+using BackgroundWorkHandler = void (*)(BackgroundWorkItem &item);
+
+// Delivery frame value meaning deliver on the first DeliverCompletions()
+// call after the work has finished, which may be in the same frame.
+const DWORD DELIVER_NEXT_FRAME = 0xFFFFFFFF;
+
+// Slow work (logging, persistence, statistics aggregation etc.) handed off
+// from a realtime thread to a background worker.  The item is copied by
+// value into the submission ring, any data the work needs has to be placed
+// in the payload.
+struct BackgroundWorkItem {
+    // Run on a background worker, the payload may be updated with a result.
+    BackgroundWorkHandler work_;
+
+    // Run on the realtime thread once the work has finished, can be nullptr.
+    BackgroundWorkHandler completion_;
+
+    // Frame (0 to MAX_FRAMES - 1) the completion is delivered on, or
+    // DELIVER_NEXT_FRAME.
+    DWORD delivery_frame_;
+
+    // Work specific data.
+    unsigned char payload_[BACKGROUND_WORK_PAYLOAD_SIZE];
+};
+
+static_assert(std::is_trivially_copyable<BackgroundWorkItem>::value,
+              "BackgroundWorkItem must be a POD");
+
+// Back-pressure statistics for a realtime thread's background work.
+struct BackgroundWorkStatistics {
+    // Total number of items accepted.
+    DWORD submitted_;
+
+    // Total number of items rejected because too many were outstanding or
+    // the delivery frame was invalid.
+    DWORD dropped_;
+
+    // Number of items waiting for a background worker.
+    DWORD queued_;
+
+    // Number of items submitted but whose completion hasn't been delivered.
+    DWORD in_flight_;
+
+    // The most items in flight at once to date.
+    DWORD worst_in_flight_;
+
+    // Total number of items whose completion has been delivered.
+    DWORD delivered_;
+};
+
+//  Connects one realtime thread to a background worker pool.
+//
+//  Submit() and DeliverCompletions() must only be called from the realtime
+//  thread, they never block, allocate or throw.  A submission is rejected
+//  (and counted as dropped) if its delivery frame is invalid or if
+//  BACKGROUND_QUEUE_SIZE items are already in flight, which also guarantees
+//  the completion side can never overflow.
+class BackgroundChannel {
+ public:
+    BackgroundChannel();
+
+    bool Submit(const BackgroundWorkItem &item);
+
+    //  Runs the completion handler of each finished item that is due.  An
+    //  item is due from the next occurrence of its delivery frame after it
+    //  finished, MAJOR_FRAME (see RealtimeThread::MajorFrame()) is used so
+    //  that an item whose frame was missed is delivered late rather than
+    //  being held in flight.  Returns the number delivered, an invalid
+    //  frame delivers nothing.
+    DWORD DeliverCompletions(DWORD major_frame, DWORD current_frame);
+
+    BackgroundWorkStatistics GetStatistics();
+    void ZeroStatistics();
+
+    //  Background worker side, runs at most one item.  Returns false if
+    //  there was nothing to do.
+    bool RunPendingWork();
+
+ private:
+    SpscRing<BackgroundWorkItem, BACKGROUND_QUEUE_SIZE> submissions_;
+    SpscRing<BackgroundWorkItem, BACKGROUND_QUEUE_SIZE> completions_;
+
+    // Finished items waiting for their delivery frame, realtime thread only.
+    BackgroundWorkItem pending_[BACKGROUND_QUEUE_SIZE];
+    uint64_t pending_due_[BACKGROUND_QUEUE_SIZE];
+    DWORD pending_count_;
+
+    // Only ever written by the realtime thread, except started_ which is
+    // only written by the worker.  They are atomic so they can be read from
+    // any thread.
+    std::atomic<DWORD> submitted_;
+    std::atomic<DWORD> dropped_;
+    std::atomic<DWORD> delivered_;
+    std::atomic<DWORD> worst_in_flight_;
+    std::atomic<DWORD> started_;
+};
+
+//  Low priority worker threads servicing a set of background channels.
+//  Each channel is serviced by exactly one worker so the rings stay single
+//  producer / single consumer.  Workers poll and sleep when idle, realtime
+//  threads never have to signal them.
+class BackgroundWorkerPool {
+ public:
+    explicit BackgroundWorkerPool(unsigned int worker_count);
+    ~BackgroundWorkerPool();
+
+    //  Channels must be added before Start() is called.
+    void AddChannel(BackgroundChannel *channel);
+
+    void Start();
+    void Stop();
+
+ private:
+    std::vector<std::thread> workers_;
+    BackgroundChannel *channels_[MAX_BACKGROUND_CHANNELS];
+    unsigned int channel_count_;
+    unsigned int worker_count_;
+    std::atomic_bool running_;
+
+    void WorkerLoop(unsigned int worker);
+    static void LowerPriority();
+};
+
+}   // namespace sprocketRealtimeScheduler
+
+#endif  // BACKGROUNDWORK_H_
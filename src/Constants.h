@@ -44,6 +44,29 @@ namespace sprocketRealtimeScheduler {
 
 const int MAX_FRAMES = 32;
 
+// Number of per-thread timestamp trace slots for clock recording and replay.
+const int MAX_CLOCK_TRACES = 32;
+
+// Maximum number of threads that can wait on the simulated clock at once.
+const int MAX_SIMULATED_WAITERS = 64;
+
+// Number of background work items a realtime thread can have outstanding,
+// this must be a power of two.
+const int BACKGROUND_QUEUE_SIZE = 64;
+
+// Size in bytes of the payload carried by a background work item.
+const int BACKGROUND_WORK_PAYLOAD_SIZE = 48;
+
+// Maximum number of realtime threads a background worker pool can serve.
+const int MAX_BACKGROUND_CHANNELS = 32;
+
+// Number of events an event server can hold waiting to be serviced, this
+// must be a power of two.
+const int EVENT_QUEUE_SIZE = 64;
+
+// Size in bytes of the payload carried by a server event.
+const int EVENT_PAYLOAD_SIZE = 48;
+
 }   // sprocketRealtimeScheduler
 
 #endif  // CONSTANTS_H_
@@ -0,0 +1,182 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of Sprocket real-time scheduler.
+GitHub : https://github.com/SwatKat1977/sprocketRealtimeScheduler
+
+Copyright 2024 Sprocket real-time scheduler Development Team
+
+    This program is free software : you can redistribute it and /or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see < https://www.gnu.org/licenses/>.
+-----------------------------------------------------------------------------
+*/
+#include <stdexcept>
+#include "EventServer.h"
+#include "SchedulerClock.h"
+
+namespace sprocketRealtimeScheduler {
+
+EventServer::EventServer(double budget_seconds) : events_dropped_(0),
+    budget_seconds_(budget_seconds), remaining_budget_(budget_seconds),
+    last_major_frame_(0), first_service_pass_(true),
+    budget_exhausted_(false) {
+    if (budget_seconds <= 0.0) throw std::runtime_error("invalid budget");
+
+    ZeroResponseTimes();
+}
+
+bool EventServer::Post(const ServerEvent &event) {
+    ServerEvent entry = event;
+    entry.arrival_time_ = ResponseTimestamp();
+
+    if (!events_.Push(entry)) {
+        events_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+DWORD EventServer::ServiceEvents(DWORD major_frame, DWORD current_frame) {
+    // This runs on the realtime thread, so don't throw (which would allocate).
+    if (current_frame >= MAX_FRAMES) return 0;
+
+    // The budget is tied to the major frame, so replenish on the first pass
+    // of each new one.  Major frames without a service pass are skipped.
+    if (first_service_pass_ || major_frame != last_major_frame_) {
+        first_service_pass_ = false;
+        ReplenishBudget();
+    }
+    last_major_frame_ = major_frame;
+
+    DWORD serviced = 0;
+    ServerEvent event;
+
+    while (remaining_budget_ > 0.0) {
+        if (!events_.Pop(event)) return serviced;
+
+        double start = TimestampSnapshot();
+        if (event.handler_) event.handler_(event);
+        double end = TimestampSnapshot();
+
+        remaining_budget_ -= (end - start);
+        CalculateResponseTime(current_frame, event.arrival_time_,
+                              ResponseTimestamp());
+        serviced++;
+
+        if (-remaining_budget_ > statistics_.worst_overrun_) {
+            statistics_.worst_overrun_ = -remaining_budget_;
+        }
+    }
+
+    // No budget left with events still queued, they wait for the next major
+    // frame.  Only counted once per major frame.
+    if (!budget_exhausted_ && events_.Size() > 0) {
+        budget_exhausted_ = true;
+        statistics_.budget_exhausted_count_++;
+    }
+
+    return serviced;
+}
+
+void EventServer::ZeroResponseTimes() {
+    statistics_.worst_response_time_ = 0.0;
+    statistics_.best_response_time_ = 99999.0;
+    statistics_.budget_exhausted_count_ = 0;
+    statistics_.worst_overrun_ = 0.0;
+    events_dropped_.store(0);
+
+    for (int idx = 0; idx < MAX_FRAMES; idx++) {
+        statistics_.response_data_[idx].total_events_serviced_ = 0;
+        statistics_.response_data_[idx].current_response_ = 0.0;
+        statistics_.response_data_[idx].average_response_ = 0.0;
+        statistics_.response_data_[idx].best_response_ = 0.0;
+        statistics_.response_data_[idx].worst_response_ = 0.0;
+        statistics_.response_data_[idx].total_response_ = 0.0;
+    }
+}
+
+EventResponseEntryData EventServer::GetResponseData(DWORD frame_no) {
+    if (frame_no >= MAX_FRAMES) throw std::runtime_error("invalid frame");
+
+    EventResponseEntryData entry;
+    entry.data_ = statistics_.response_data_[frame_no];
+    entry.worst_response_time_ = statistics_.worst_response_time_;
+    entry.best_response_time_ = statistics_.best_response_time_;
+    entry.budget_exhausted_count_ = statistics_.budget_exhausted_count_;
+    entry.events_dropped_ = events_dropped_.load();
+    entry.worst_overrun_ = statistics_.worst_overrun_;
+    entry.budget_debt_ = remaining_budget_ < 0.0 ? -remaining_budget_ : 0.0;
+    return entry;
+}
+
+double EventServer::TimestampSnapshot() {
+    return SchedulerClock::Snapshot();
+}
+
+double EventServer::ResponseTimestamp() {
+    // Uses Now() rather than Snapshot() as arrivals are stamped on another
+    // thread, which must not record or consume samples in the realtime
+    // thread's timing trace.  Completions use it too so both ends of a
+    // response time come from the same clock.
+    return std::chrono::duration<double>(SchedulerClock::Now()).count();
+}
+
+void EventServer::ReplenishBudget() {
+    // Any overrun from the previous major frame is paid back here, capped
+    // at one budget so the server is never starved for more than one major
+    // frame.  Unused budget is not carried over.
+    if (remaining_budget_ < -budget_seconds_) {
+        remaining_budget_ = 0.0;
+    } else if (remaining_budget_ < 0.0) {
+        remaining_budget_ += budget_seconds_;
+    } else {
+        remaining_budget_ = budget_seconds_;
+    }
+
+    budget_exhausted_ = false;
+}
+
+void EventServer::CalculateResponseTime(DWORD frame, double arrival_time,
+                                        double completion_time) {
+    EventResponseEntry &data = statistics_.response_data_[frame];
+
+    // Calculate the response time delta (in seconds).
+    double delta = completion_time - arrival_time;
+
+    data.total_events_serviced_++;
+    data.current_response_ = delta;
+    data.total_response_ += delta;
+    data.average_response_ = data.total_response_ /
+                             data.total_events_serviced_;
+
+    // Best response time gets zero'd to 0.0, if it is at the initial value
+    // then always set a best time.
+    if (data.best_response_ == 0.0 || delta < data.best_response_) {
+        data.best_response_ = delta;
+    }
+
+    // Check to see if the worst response time needs updating.
+    if (delta >= data.worst_response_) {
+        data.worst_response_ = delta;
+    }
+
+    // Store the worst and best response times of any frame.
+    if (delta >= statistics_.worst_response_time_) {
+        statistics_.worst_response_time_ = delta;
+    }
+    if (delta <= statistics_.best_response_time_) {
+        statistics_.best_response_time_ = delta;
+    }
+}
+
+}   // namespace sprocketRealtimeScheduler
@@ -0,0 +1,112 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of Sprocket real-time scheduler.
+GitHub : https://github.com/SwatKat1977/sprocketRealtimeScheduler
+
+Copyright 2024 Sprocket real-time scheduler Development Team
+
+    This program is free software : you can redistribute it and /or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see < https://www.gnu.org/licenses/>.
+-----------------------------------------------------------------------------
+*/
+#ifndef EVENTSERVER_H_
+#define EVENTSERVER_H_
+#include <atomic>
+#include <type_traits>
+#include "Constants.h"
+#include "SpscRing.h"
+#include "ThreadStatistics.h"
+
+namespace sprocketRealtimeScheduler {
+
+struct ServerEvent;
+
+using ServerEventHandler = void (*)(ServerEvent &event);
+
+// An aperiodic event (e.g. an I/O arrival) to be serviced by a realtime
+// thread.  Any data the handler needs has to be placed in the payload.
+struct ServerEvent {
+    ServerEventHandler handler_;
+
+    // Time the event was posted (in seconds), set by Post() from
+    // SchedulerClock::Now().
+    double arrival_time_;
+
+    // Event specific data.
+    unsigned char payload_[EVENT_PAYLOAD_SIZE];
+};
+
+static_assert(std::is_trivially_copyable<ServerEvent>::value,
+              "ServerEvent must be a POD");
+
+//  Deferrable server giving a realtime thread a fixed budget of time per
+//  major frame in which to service aperiodic events, so bursts of events
+//  can't starve the periodic frames.
+//
+//  The budget is replenished in full at the start of every major frame and
+//  unused budget isn't carried over.  Handlers aren't pre-empted, so an
+//  event is only started while budget remains; any overrun by the last
+//  event is deducted from the next replenishment.  The carried debt is
+//  capped at one budget, so a single long handler can at worst leave the
+//  server without budget for one major frame.
+//
+//  Budget use is measured with SchedulerClock::Snapshot(), the same source
+//  as the frame timing statistics, so it is reproduced when a trace is
+//  replayed.  Response times are measured with SchedulerClock::Now() at
+//  both ends (arrival on the producer thread, completion on the realtime
+//  thread) as the producer mustn't touch the realtime thread's trace.
+//
+//  Post() may be called from a single producer thread, everything else
+//  must only be called from the realtime thread.
+class EventServer {
+ public:
+    explicit EventServer(double budget_seconds);
+
+    //  Queue an event, returns false (and counts it as dropped) if the
+    //  queue is full.  Never blocks.
+    bool Post(const ServerEvent &event);
+
+    //  Call from ThreadLoop(), services queued events until the queue is
+    //  empty or the budget has been used.  MAJOR_FRAME is the count of major
+    //  frames run (see RealtimeThread::MajorFrame()), the budget is
+    //  replenished whenever it changes.  Returns the number of events
+    //  serviced, an invalid frame services nothing.
+    DWORD ServiceEvents(DWORD major_frame, DWORD current_frame);
+
+    double Budget() { return budget_seconds_; }
+    double RemainingBudget() { return remaining_budget_; }
+    size_t QueuedEvents() { return events_.Size(); }
+
+    void ZeroResponseTimes();
+    EventResponseEntryData GetResponseData(DWORD frame_no);
+
+ protected:
+    SpscRing<ServerEvent, EVENT_QUEUE_SIZE> events_;
+    EventServerStatistics statistics_;
+    std::atomic<unsigned int> events_dropped_;
+    double budget_seconds_;
+    double remaining_budget_;
+    DWORD last_major_frame_;
+    bool first_service_pass_;
+    bool budget_exhausted_;
+
+    double TimestampSnapshot();
+    double ResponseTimestamp();
+    void ReplenishBudget();
+    void CalculateResponseTime(DWORD frame, double arrival_time,
+                               double completion_time);
+};
+
+}   // namespace sprocketRealtimeScheduler
+
+#endif  // EVENTSERVER_H_
@@ -20,11 +20,12 @@ Copyright 2024 Sprocket real-time scheduler Development Team
 -----------------------------------------------------------------------------
 */
 #include "RealtimeThread.h"
+#include "AllocationGuard.h"
 
 namespace sprocketRealtimeScheduler {
 
-RealtimeThread::RealtimeThread() : current_frame_(0),
-    frame_mask_(0x80000000) {
+RealtimeThread::RealtimeThread() : current_frame_(0), major_frame_(0),
+    frame_mask_(0x80000000), trace_slot_(NO_CLOCK_TRACE) {
 }
 
 void RealtimeThread::StartThread() {
@@ -32,11 +33,25 @@ void RealtimeThread::StartThread() {
     ZeroFrameTimes();
     ZeroThreadStartJitter();
 
-    while (kill_thread_.WaitFor(TIMEOUT_IMMEDIATE) ==
-                                std::cv_status::timeout) {
-        ThreadLoop();
+    // Binding the trace slot can throw, so is done before the allocation
+    // guard is armed.
+    SchedulerClock::RegisterThread();
+    if (trace_slot_ != NO_CLOCK_TRACE) ClockTraces::Bind(trace_slot_);
+
+    // From here on the thread must not touch the heap, in debug builds with
+    // SPROCKET_TRAP_RT_ALLOCATIONS any attempt will abort.
+    {
+        RealtimeAllocationGuard no_allocations;
+
+        while (kill_thread_.WaitFor(TIMEOUT_IMMEDIATE) ==
+                                    std::cv_status::timeout) {
+            ThreadLoop();
+        }
     }
 
+    ClockTraces::Unbind();
+    SchedulerClock::UnregisterThread();
+
     // Acknowledge the thread is now dead.
     thread_dead_.Notify();
 }
@@ -86,6 +101,10 @@ ThreadStartTimeJitterEntryData RealtimeThread::GetThreadStartJitterData(
     return entry;
 }
 
+double RealtimeThread::TimestampSnapshot() {
+    return SchedulerClock::Snapshot();
+}
+
 DWORD RealtimeThread::IncrementCurrentFrame() {
     current_frame_++;
     frame_mask_ = frame_mask_ >> 1;
@@ -93,6 +112,7 @@ DWORD RealtimeThread::IncrementCurrentFrame() {
     if (current_frame_ >= MAX_FRAMES) {
         current_frame_ = 0;
         frame_mask_ = 0x80000000;
+        major_frame_++;
     }
 
     return current_frame_;
@@ -23,6 +23,7 @@ Copyright 2024 Sprocket real-time scheduler Development Team
 #define REALTIMETHREAD_H_
 #include <thread>               // NOLINT
 #include "Constants.h"
+#include "SchedulerClock.h"
 #include "ThreadStatistics.h"
 #include "ThreadCondition.h"
 
@@ -59,18 +60,29 @@ class RealtimeThread : public std::thread {
 
     DWORD IncrementCurrentFrame();
     DWORD CurrentFrame() { return current_frame_; }
+    DWORD MajorFrame() { return major_frame_; }
+
+    // Clock trace slot the thread records to or replays from, see
+    // ClockTraces.  Must be set before the thread is started.
+    void TraceSlot(DWORD slot) { trace_slot_ = slot; }
+    DWORD TraceSlot() { return trace_slot_; }
 
  protected:
     ThreadStatistics statistics_;
     double cpu_ticks_per_second_;
     DWORD current_frame_;
+    DWORD major_frame_;
     DWORD frame_mask_;
+    DWORD trace_slot_;
     double supervior_thread_start_time_;
     double supervior_thread_stop_time_;
     double wanted_frame_period_seconds_;
 
     ~RealtimeThread() = default;
 
+    // Current time in seconds from SchedulerClock, which is the real steady
+    // clock unless built with SPROCKET_SIMULATED_CLOCK (virtual time/replay)
+    // or SPROCKET_RECORDING_CLOCK (real time, recorded for replay).
     double TimestampSnapshot();
     void CalculateFrameTimings(int current_frame, double frame_start,
                                double frame_end);
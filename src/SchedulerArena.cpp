@@ -0,0 +1,155 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of Sprocket real-time scheduler.
+GitHub : https://github.com/SwatKat1977/sprocketRealtimeScheduler
+
+Copyright 2024 Sprocket real-time scheduler Development Team
+
+    This program is free software : you can redistribute it and /or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see < https://www.gnu.org/licenses/>.
+-----------------------------------------------------------------------------
+*/
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "SchedulerArena.h"
+
+#if (PLATFORM_TYPE == PLATFORM_LINUX)
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#else
+#include <windows.h>
+#endif
+
+namespace sprocketRealtimeScheduler {
+
+static size_t RoundUp(size_t value, size_t multiple) {
+    return ((value + multiple - 1) / multiple) * multiple;
+}
+
+#if (PLATFORM_TYPE == PLATFORM_LINUX)
+/*
+Default huge page size as reported by the kernel, or 0 if it isn't known.
+*/
+static size_t HugePageSize() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+
+    while (std::getline(meminfo, line)) {
+        unsigned long size_kb = 0;   // NOLINT
+
+        if (std::sscanf(line.c_str(), "Hugepagesize: %lu kB", &size_kb) == 1) {
+            return static_cast<size_t>(size_kb) * 1024;
+        }
+    }
+
+    return 0;
+}
+#endif
+
+SchedulerArena::SchedulerArena(size_t size) : region_(nullptr),
+    capacity_(0), used_(0), huge_pages_(false) {
+    if (size == 0) throw std::runtime_error("invalid arena size");
+
+#if (PLATFORM_TYPE == PLATFORM_LINUX)
+    size_t huge_page = HugePageSize();
+    void *region = MAP_FAILED;
+
+    if (huge_page != 0) {
+        capacity_ = RoundUp(size, huge_page);
+        region = mmap(nullptr, capacity_, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+
+    if (region != MAP_FAILED) {
+        huge_pages_ = true;
+    } else {
+        // No huge pages reserved on the system, use normal pages instead.
+        capacity_ = RoundUp(size, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+        region = mmap(nullptr, capacity_, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED) {
+            throw std::runtime_error("unable to reserve arena memory");
+        }
+    }
+
+    if (mlock(region, capacity_) != 0) {
+        munmap(region, capacity_);
+        throw std::runtime_error("unable to lock arena memory");
+    }
+#else
+    SIZE_T large_page = GetLargePageMinimum();
+    void *region = nullptr;
+
+    if (large_page != 0) {
+        capacity_ = RoundUp(size, large_page);
+        region = VirtualAlloc(nullptr, capacity_,
+                              MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                              PAGE_READWRITE);
+        // Large pages are always locked in memory.
+        if (region) huge_pages_ = true;
+    }
+
+    if (!region) {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        capacity_ = RoundUp(size, info.dwPageSize);
+        region = VirtualAlloc(nullptr, capacity_, MEM_RESERVE | MEM_COMMIT,
+                              PAGE_READWRITE);
+        if (!region) {
+            throw std::runtime_error("unable to reserve arena memory");
+        }
+
+        if (!VirtualLock(region, capacity_)) {
+            VirtualFree(region, 0, MEM_RELEASE);
+            throw std::runtime_error("unable to lock arena memory");
+        }
+    }
+#endif
+
+    region_ = static_cast<unsigned char *>(region);
+
+    // Touch every page now so there are no page faults later on and so that
+    // the pages are placed on the NUMA node of the constructing thread.
+    std::memset(region_, 0, capacity_);
+}
+
+SchedulerArena::~SchedulerArena() {
+#if (PLATFORM_TYPE == PLATFORM_LINUX)
+    munlock(region_, capacity_);
+    munmap(region_, capacity_);
+#else
+    if (!huge_pages_) VirtualUnlock(region_, capacity_);
+    VirtualFree(region_, 0, MEM_RELEASE);
+#endif
+}
+
+void *SchedulerArena::Allocate(size_t size, size_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        throw std::runtime_error("invalid alignment");
+    }
+
+    uintptr_t base = reinterpret_cast<uintptr_t>(region_);
+    uintptr_t aligned = RoundUp(base + used_, alignment);
+    size_t offset = aligned - base;
+
+    if (offset > capacity_ || size > capacity_ - offset) throw std::bad_alloc();
+
+    used_ = offset + size;
+    return region_ + offset;
+}
+
+}   // namespace sprocketRealtimeScheduler
@@ -0,0 +1,108 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of Sprocket real-time scheduler.
+GitHub : https://github.com/SwatKat1977/sprocketRealtimeScheduler
+
+Copyright 2024 Sprocket real-time scheduler Development Team
+
+    This program is free software : you can redistribute it and /or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see < https://www.gnu.org/licenses/>.
+-----------------------------------------------------------------------------
+*/
+#ifndef SCHEDULERARENA_H_
+#define SCHEDULERARENA_H_
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "Constants.h"
+
+namespace sprocketRealtimeScheduler {
+
+//  Fixed size region to hold scheduler state so nothing needs the heap once
+//  threads start.  ClockTraces takes its trace buffers from an arena; the
+//  realtime objects (RealtimeThread derived classes with their statistics,
+//  BackgroundChannel and EventServer with their rings) have no heap members
+//  and can be placed in one whole with Create().
+//
+//  The region is reserved once at construction, backed by huge pages where
+//  the platform allows it (falling back to normal pages), locked into memory
+//  and pre-faulted.  Pages are touched by the constructing thread, so create
+//  one arena per core from a thread already pinned to that core for the
+//  memory to be NUMA-local under a first-touch policy.
+//
+//  Allocation just bumps an offset and isn't thread safe, it is intended to
+//  be done at startup.  There is no freeing of individual objects; the whole
+//  region is released when the arena is destroyed.  Objects made with
+//  Create() or CreateArray() must be destroyed with Destroy() or
+//  DestroyArray() before then if they have non-trivial destructors.
+class SchedulerArena {
+ public:
+    explicit SchedulerArena(size_t size);
+    ~SchedulerArena();
+
+    SchedulerArena(const SchedulerArena &) = delete;
+    SchedulerArena &operator=(const SchedulerArena &) = delete;
+
+    //  Returns aligned storage from the arena, throws std::bad_alloc if the
+    //  arena has been exhausted.  ALIGNMENT must be a power of two.
+    void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    template<typename T, typename... Args>
+    T *Create(Args &&... args) {
+        void *storage = Allocate(sizeof(T), alignof(T));
+        return new (storage) T(std::forward<Args>(args)...);
+    }
+
+    //  Elements are value-initialised one at a time, placement array new
+    //  may need more storage than sizeof(T) * COUNT.
+    template<typename T>
+    T *CreateArray(size_t count) {
+        T *array = static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+        size_t idx = 0;
+
+        try {
+            for (; idx < count; idx++) new (array + idx) T();
+        } catch (...) {
+            DestroyArray(array, idx);
+            throw;
+        }
+
+        return array;
+    }
+
+    template<typename T>
+    void Destroy(T *object) { if (object) object->~T(); }
+
+    template<typename T>
+    void DestroyArray(T *array, size_t count) {
+        if (!array) return;
+
+        // Reverse order of construction.
+        while (count > 0) array[--count].~T();
+    }
+
+    size_t Capacity() const { return capacity_; }
+    size_t Used() const { return used_; }
+    size_t Available() const { return capacity_ - used_; }
+    bool IsHugePageBacked() const { return huge_pages_; }
+
+ private:
+    unsigned char *region_;
+    size_t capacity_;
+    size_t used_;
+    bool huge_pages_;
+};
+
+}   // namespace sprocketRealtimeScheduler
+
+#endif  // SCHEDULERARENA_H_
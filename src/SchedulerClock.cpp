@@ -0,0 +1,322 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of Sprocket real-time scheduler.
+GitHub : https://github.com/SwatKat1977/sprocketRealtimeScheduler
+
+Copyright 2024 Sprocket real-time scheduler Development Team
+
+    This program is free software : you can redistribute it and /or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see < https://www.gnu.org/licenses/>.
+-----------------------------------------------------------------------------
+*/
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include "SchedulerArena.h"
+#include "SchedulerClock.h"
+
+namespace sprocketRealtimeScheduler {
+
+// Waiter index used when the caller isn't itself a waiter.
+const DWORD NO_WAITER = 0xFFFFFFFF;
+
+ClockTraces::Trace ClockTraces::traces_[MAX_CLOCK_TRACES];
+thread_local ClockTraces::Trace *ClockTraces::current_ = nullptr;
+
+std::atomic<int64_t> SimulatedClock::now_nsecs_(0);
+std::mutex SimulatedClock::time_mutex_;
+SimulatedClock::Waiter SimulatedClock::waiters_[MAX_SIMULATED_WAITERS];
+unsigned int SimulatedClock::participants_ = 0;
+unsigned int SimulatedClock::blocked_ = 0;
+thread_local bool SimulatedClock::registered_ = false;
+
+ClockTraces::Trace &ClockTraces::Get(DWORD trace) {
+    if (trace >= MAX_CLOCK_TRACES) throw std::runtime_error("invalid trace");
+
+    return traces_[trace];
+}
+
+void ClockTraces::Bind(DWORD trace) {
+    Trace &entry = Get(trace);
+
+    if (current_ == &entry) return;
+
+    if (entry.bound_.exchange(true)) {
+        throw std::runtime_error("trace already bound");
+    }
+
+    Unbind();
+    current_ = &entry;
+}
+
+void ClockTraces::Unbind() {
+    if (!current_) return;
+
+    current_->bound_.store(false);
+    current_ = nullptr;
+}
+
+void ClockTraces::Load(DWORD trace, const std::vector<double> &samples,
+                       SchedulerArena &arena) {
+    Trace &entry = Get(trace);
+    entry.samples_ = arena.CreateArray<double>(samples.size());
+    std::copy(samples.begin(), samples.end(), entry.samples_);
+    entry.size_ = samples.size();
+    entry.capacity_ = 0;
+    entry.position_.store(0);
+}
+
+size_t ClockTraces::Remaining(DWORD trace) {
+    Trace &entry = Get(trace);
+    size_t position = entry.position_.load();
+
+    return position < entry.size_ ? entry.size_ - position : 0;
+}
+
+void ClockTraces::Reserve(DWORD trace, size_t samples,
+                          SchedulerArena &arena) {
+    Trace &entry = Get(trace);
+    entry.samples_ = arena.CreateArray<double>(samples);
+    entry.size_ = 0;
+    entry.capacity_ = samples;
+    entry.position_.store(0);
+}
+
+std::vector<double> ClockTraces::Recorded(DWORD trace) {
+    Trace &entry = Get(trace);
+
+    return std::vector<double>(entry.samples_, entry.samples_ + entry.size_);
+}
+
+void ClockTraces::Clear() {
+    for (int idx = 0; idx < MAX_CLOCK_TRACES; idx++) {
+        traces_[idx].samples_ = nullptr;
+        traces_[idx].size_ = 0;
+        traces_[idx].capacity_ = 0;
+        traces_[idx].position_.store(0);
+    }
+}
+
+bool ClockTraces::NextSample(double &sample) {
+    if (!current_) return false;
+
+    size_t position = current_->position_.load(std::memory_order_relaxed);
+    if (position >= current_->size_) return false;
+
+    sample = current_->samples_[position];
+    current_->position_.store(position + 1, std::memory_order_relaxed);
+    return true;
+}
+
+void ClockTraces::RecordSample(double sample) {
+    // Never write past the reserved storage.
+    if (!current_ || current_->size_ >= current_->capacity_) return;
+
+    current_->samples_[current_->size_++] = sample;
+}
+
+double SimulatedClock::Snapshot() {
+    double sample;
+
+    if (ClockTraces::NextSample(sample)) return sample;
+
+    return std::chrono::duration<double>(Now()).count();
+}
+
+void SimulatedClock::Wait(std::condition_variable &condition,
+                          std::unique_lock<std::mutex> &lock) {
+    WaitUntil(condition, lock, clock_time_nsecs::max());
+}
+
+/*
+Called with the caller's condition mutex held (LOCK).  The wait may return
+early without the condition having been notified, callers already loop to
+cope with spurious wakeups.
+*/
+std::cv_status SimulatedClock::WaitUntil(std::condition_variable &condition,
+                                         std::unique_lock<std::mutex> &lock,
+                                         const clock_time_nsecs &deadline) {
+    DWORD self = AddWaiter(condition, lock, deadline);
+
+    // If this was the last participant to block, time moves on here.  When
+    // other waiters had to be woken the lock was released meanwhile, so a
+    // notify may have been missed: return and let the caller check again.
+    bool released = WakeExpired(self, &lock) > 0;
+
+    if (!released && Now() < deadline) condition.wait(lock);
+
+    RemoveWaiter(self);
+
+    return Now() >= deadline ? std::cv_status::timeout :
+                               std::cv_status::no_timeout;
+}
+
+void SimulatedClock::Notified(std::condition_variable &condition) {
+    std::lock_guard<std::mutex> guard(time_mutex_);
+
+    for (DWORD idx = 0; idx < MAX_SIMULATED_WAITERS; idx++) {
+        Waiter &waiter = waiters_[idx];
+
+        if (waiter.in_use_ && !waiter.notified_ &&
+            waiter.condition_ == &condition) {
+            waiter.notified_ = true;
+            blocked_--;
+        }
+    }
+}
+
+void SimulatedClock::RegisterThread() {
+    std::lock_guard<std::mutex> guard(time_mutex_);
+
+    if (registered_) return;
+
+    registered_ = true;
+    participants_++;
+}
+
+void SimulatedClock::UnregisterThread() {
+    {
+        std::lock_guard<std::mutex> guard(time_mutex_);
+
+        if (!registered_) return;
+
+        registered_ = false;
+        participants_--;
+    }
+
+    // Everyone left may now be blocked.
+    WakeExpired(NO_WAITER, nullptr);
+}
+
+void SimulatedClock::Advance(const clock_time_nsecs &delta) {
+    if (delta.count() > 0) now_nsecs_.fetch_add(delta.count());
+
+    WakeExpired(NO_WAITER, nullptr);
+}
+
+void SimulatedClock::AdvanceTo(const clock_time_nsecs &time) {
+    int64_t current = now_nsecs_.load();
+
+    // Only ever move forward, another thread may have got there first.
+    while (current < time.count() &&
+           !now_nsecs_.compare_exchange_weak(current, time.count())) {
+    }
+
+    WakeExpired(NO_WAITER, nullptr);
+}
+
+void SimulatedClock::Reset(const clock_time_nsecs &time) {
+    now_nsecs_.store(time.count());
+}
+
+DWORD SimulatedClock::AddWaiter(std::condition_variable &condition,
+                                std::unique_lock<std::mutex> &lock,
+                                const clock_time_nsecs &deadline) {
+    std::lock_guard<std::mutex> guard(time_mutex_);
+
+    for (DWORD idx = 0; idx < MAX_SIMULATED_WAITERS; idx++) {
+        if (waiters_[idx].in_use_) continue;
+
+        waiters_[idx].deadline_ = deadline;
+        waiters_[idx].condition_ = &condition;
+        waiters_[idx].mutex_ = lock.mutex();
+        waiters_[idx].in_use_ = true;
+        waiters_[idx].notified_ = false;
+
+        blocked_++;
+        if (!registered_) participants_++;
+        return idx;
+    }
+
+    // Not thrown, this can be reached from a realtime thread.
+    std::fprintf(stderr, "too many simulated clock waiters\n");
+    std::abort();
+}
+
+void SimulatedClock::RemoveWaiter(DWORD waiter) {
+    std::lock_guard<std::mutex> guard(time_mutex_);
+
+    waiters_[waiter].in_use_ = false;
+    if (!waiters_[waiter].notified_) blocked_--;
+    if (!registered_) participants_--;
+}
+
+/*
+Must be called with time_mutex_ held.  If every participant is blocked the
+clock is moved to the earliest deadline, then every waiter (other than SELF)
+whose deadline has been reached is copied to EXPIRED.  Returns the number of
+expired waiters.
+*/
+DWORD SimulatedClock::CollectExpired(DWORD self, Waiter *expired) {
+    if (blocked_ > 0 && blocked_ == participants_) {
+        clock_time_nsecs earliest = clock_time_nsecs::max();
+
+        for (DWORD idx = 0; idx < MAX_SIMULATED_WAITERS; idx++) {
+            if (waiters_[idx].in_use_ && waiters_[idx].deadline_ < earliest) {
+                earliest = waiters_[idx].deadline_;
+            }
+        }
+
+        // Nobody has a deadline when everyone waits forever.
+        if (earliest != clock_time_nsecs::max() &&
+            earliest.count() > now_nsecs_.load()) {
+            now_nsecs_.store(earliest.count());
+        }
+    }
+
+    DWORD count = 0;
+    int64_t now = now_nsecs_.load();
+
+    for (DWORD idx = 0; idx < MAX_SIMULATED_WAITERS; idx++) {
+        if (idx == self || !waiters_[idx].in_use_) continue;
+
+        if (waiters_[idx].deadline_.count() <= now) {
+            expired[count++] = waiters_[idx];
+        }
+    }
+
+    return count;
+}
+
+/*
+Wake every expired waiter (see CollectExpired).  LOCK, the caller's own
+condition mutex if it is a waiter, is released while the other waiters'
+mutexes are taken so that two threads can never hold each other's mutex.
+Returns the number of waiters woken.
+*/
+DWORD SimulatedClock::WakeExpired(DWORD self,
+                                  std::unique_lock<std::mutex> *lock) {
+    Waiter expired[MAX_SIMULATED_WAITERS];
+    DWORD count;
+
+    {
+        std::lock_guard<std::mutex> guard(time_mutex_);
+        count = CollectExpired(self, expired);
+    }
+
+    if (count == 0) return 0;
+
+    if (lock) lock->unlock();
+
+    for (DWORD idx = 0; idx < count; idx++) {
+        std::lock_guard<std::mutex> guard(*expired[idx].mutex_);
+        expired[idx].condition_->notify_all();
+    }
+
+    if (lock) lock->lock();
+
+    return count;
+}
+
+}   // namespace sprocketRealtimeScheduler
@@ -0,0 +1,235 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of Sprocket real-time scheduler.
+GitHub : https://github.com/SwatKat1977/sprocketRealtimeScheduler
+
+Copyright 2024 Sprocket real-time scheduler Development Team
+
+    This program is free software : you can redistribute it and /or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see < https://www.gnu.org/licenses/>.
+-----------------------------------------------------------------------------
+*/
+#ifndef SCHEDULERCLOCK_H_
+#define SCHEDULERCLOCK_H_
+#include <atomic>
+#include <cstddef>
+#include <chrono>               // NOLINT
+#include <condition_variable>   // NOLINT
+#include <cstdint>
+#include <mutex>                // NOLINT
+#include <vector>
+#include "Constants.h"
+
+namespace sprocketRealtimeScheduler {
+
+//  Absolute time on a scheduler clock, measured from the clock's epoch.
+using clock_time_nsecs = std::chrono::nanoseconds;
+
+// Trace slot value meaning a thread doesn't record or replay a trace.
+const DWORD NO_CLOCK_TRACE = 0xFFFFFFFF;
+
+class SchedulerArena;
+
+//  Timestamp traces used to record the snapshots taken during a real run and
+//  replay them later under the simulated clock.
+//
+//  There is a trace slot per thread: a thread binds itself to a slot with
+//  Bind() before it starts taking snapshots (RealtimeThread does this for
+//  its TraceSlot() in StartThread()), and each slot can only be bound by one
+//  thread at a time.  This keeps the samples a thread records or replays
+//  independent of how the OS schedules the other threads.
+//
+//  Sample storage is taken from a SchedulerArena so that it is locked and
+//  pre-faulted, recording never page faults on the realtime thread.
+//
+//  Load(), Reserve() and Recorded() must only be called while the thread
+//  bound to that slot isn't running.
+class ClockTraces {
+ public:
+    static void Bind(DWORD trace);
+    static void Unbind();
+
+    //  Replay: the samples (in seconds) the bound thread's snapshots return.
+    static void Load(DWORD trace, const std::vector<double> &samples,
+                     SchedulerArena &arena);
+    static size_t Remaining(DWORD trace);
+
+    //  Recording: room for up to SAMPLES snapshots is taken from the arena,
+    //  snapshots beyond that aren't recorded.
+    static void Reserve(DWORD trace, size_t samples, SchedulerArena &arena);
+    static std::vector<double> Recorded(DWORD trace);
+
+    //  Forget all loaded and recorded samples, the storage itself belongs to
+    //  the arena it came from.
+    static void Clear();
+
+    //  Used by the clock policies on the bound thread, never allocate.
+    static bool NextSample(double &sample);
+    static void RecordSample(double sample);
+
+ private:
+    struct Trace {
+        double *samples_;
+        size_t size_;
+        size_t capacity_;
+        std::atomic<size_t> position_;
+        std::atomic_bool bound_;
+    };
+
+    static Trace traces_[MAX_CLOCK_TRACES];
+    static thread_local Trace *current_;
+
+    static Trace &Get(DWORD trace);
+};
+
+//  The clock and wait backend is chosen at compile time so that the real
+//  clock costs nothing over calling std::chrono::steady_clock directly.
+//  Every clock policy provides the same static interface:
+//
+//    Now()              - current time, used for wait deadlines.
+//    Snapshot()         - current time in seconds, used for the timing
+//                         statistics.
+//    Wait()             - block on a condition until notified.
+//    WaitUntil()        - block on a condition until notified or the
+//                         deadline.
+//    Notified()         - a condition has been notified, called by the
+//                         notifier with the condition's mutex held.
+//    RegisterThread()   - the calling thread takes part in virtual time
+//    UnregisterThread()   (only meaningful to the simulated clock).
+//
+
+// Real clock backed by std::chrono::steady_clock.
+class SteadyClock {
+ public:
+    static constexpr bool IS_SIMULATED = false;
+
+    static clock_time_nsecs Now() {
+        return std::chrono::duration_cast<clock_time_nsecs>(
+            std::chrono::steady_clock::now().time_since_epoch());
+    }
+
+    static double Snapshot() {
+        return std::chrono::duration<double>(Now()).count();
+    }
+
+    static void Wait(std::condition_variable &condition,
+                     std::unique_lock<std::mutex> &lock) {
+        condition.wait(lock);
+    }
+
+    static std::cv_status WaitUntil(std::condition_variable &condition,
+                                    std::unique_lock<std::mutex> &lock,
+                                    const clock_time_nsecs &deadline) {
+        return condition.wait_for(lock, deadline - Now());
+    }
+
+    static void Notified(std::condition_variable &) {}
+    static void RegisterThread() {}
+    static void UnregisterThread() {}
+};
+
+//  Real clock that also records every snapshot into the calling thread's
+//  trace slot (see ClockTraces), so the run can be replayed later.
+class RecordingClock : public SteadyClock {
+ public:
+    static double Snapshot() {
+        double sample = SteadyClock::Snapshot();
+        ClockTraces::RecordSample(sample);
+        return sample;
+    }
+};
+
+//  Virtual clock for deterministic testing and replay, run as a discrete
+//  event simulation.  Time never moves while any registered thread is still
+//  running: only once every registered thread is blocked in a wait does the
+//  clock jump to the earliest deadline, waking the waiters that have then
+//  expired.  Until that happens a waiter really waits on its condition, so
+//  a Notify() always beats a timeout that hasn't been reached.  This allows
+//  a long schedule to run as fast as the frames themselves execute.
+//
+//  Threads that take part in the schedule (RealtimeThread does so in
+//  StartThread(), a supervisor thread must do so itself) call
+//  RegisterThread() first.  A thread that isn't registered only counts as
+//  a participant while it is waiting.
+//
+//  While the calling thread's trace slot has samples left Snapshot()
+//  returns them in order, after that it falls back to virtual time.
+class SimulatedClock {
+ public:
+    static constexpr bool IS_SIMULATED = true;
+
+    static clock_time_nsecs Now() {
+        return clock_time_nsecs(now_nsecs_.load());
+    }
+
+    static double Snapshot();
+
+    static void Wait(std::condition_variable &condition,
+                     std::unique_lock<std::mutex> &lock);
+
+    static std::cv_status WaitUntil(std::condition_variable &condition,
+                                    std::unique_lock<std::mutex> &lock,
+                                    const clock_time_nsecs &deadline);
+
+    //  A notified waiter is about to run again, so it no longer counts as
+    //  blocked and time can't move until it has waited again.
+    static void Notified(std::condition_variable &condition);
+
+    static void RegisterThread();
+    static void UnregisterThread();
+
+    //  Move the clock forward, it will never go backwards.  Waiters whose
+    //  deadline has been reached are woken.
+    static void Advance(const clock_time_nsecs &delta);
+    static void AdvanceTo(const clock_time_nsecs &time);
+
+    //  Reset the clock to a given time, no thread may be waiting.
+    static void Reset(const clock_time_nsecs &time = clock_time_nsecs(0));
+
+ private:
+    struct Waiter {
+        clock_time_nsecs deadline_;
+        std::condition_variable *condition_;
+        std::mutex *mutex_;
+        bool in_use_;
+        bool notified_;
+    };
+
+    static std::atomic<int64_t> now_nsecs_;
+
+    // Waiter bookkeeping, protected by time_mutex_.
+    static std::mutex time_mutex_;
+    static Waiter waiters_[MAX_SIMULATED_WAITERS];
+    static unsigned int participants_;
+    static unsigned int blocked_;
+    static thread_local bool registered_;
+
+    static DWORD AddWaiter(std::condition_variable &condition,
+                           std::unique_lock<std::mutex> &lock,
+                           const clock_time_nsecs &deadline);
+    static void RemoveWaiter(DWORD waiter);
+    static DWORD CollectExpired(DWORD self, Waiter *expired);
+    static DWORD WakeExpired(DWORD self, std::unique_lock<std::mutex> *lock);
+};
+
+#if defined(SPROCKET_SIMULATED_CLOCK)
+using SchedulerClock = SimulatedClock;
+#elif defined(SPROCKET_RECORDING_CLOCK)
+using SchedulerClock = RecordingClock;
+#else
+using SchedulerClock = SteadyClock;
+#endif
+
+}   // namespace sprocketRealtimeScheduler
+
+#endif  // SCHEDULERCLOCK_H_
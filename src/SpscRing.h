@@ -0,0 +1,85 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of Sprocket real-time scheduler.
+GitHub : https://github.com/SwatKat1977/sprocketRealtimeScheduler
+
+Copyright 2024 Sprocket real-time scheduler Development Team
+
+    This program is free software : you can redistribute it and /or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see < https://www.gnu.org/licenses/>.
+-----------------------------------------------------------------------------
+*/
+#ifndef SPSCRING_H_
+#define SPSCRING_H_
+#include <atomic>
+#include <cstddef>
+
+namespace sprocketRealtimeScheduler {
+
+//  Bounded single producer / single consumer ring.  Push and Pop are wait
+//  free, never allocate and never block, which makes it safe to use from a
+//  real-time thread provided only one thread pushes and one thread pops.
+//
+//  CAPACITY must be a power of two.
+template<typename T, size_t CAPACITY>
+class SpscRing {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+ public:
+    SpscRing() : head_(0), tail_(0) {}
+
+    //  Producer only.  Returns false if the ring is full.
+    bool Push(const T &item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+
+        if (tail - head_.load(std::memory_order_acquire) == CAPACITY) {
+            return false;
+        }
+
+        items_[tail & (CAPACITY - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    //  Consumer only.  Returns false if the ring is empty.
+    bool Pop(T &item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+
+        item = items_[head & (CAPACITY - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    //  Approximate when called from a thread that is neither the producer
+    //  nor the consumer.
+    size_t Size() const {
+        return tail_.load(std::memory_order_acquire) -
+               head_.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t Capacity() { return CAPACITY; }
+
+ private:
+    // Head and tail are kept on separate cache lines so the producer and
+    // consumer don't contend with each other.
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+    alignas(64) T items_[CAPACITY];
+};
+
+}   // namespace sprocketRealtimeScheduler
+
+#endif  // SPSCRING_H_
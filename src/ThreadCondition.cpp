@@ -47,6 +47,7 @@ void ThreadCondition::Notify() {
     //
     std::unique_lock<std::mutex> lock(mutex_);
     flag_.store(true);
+    SchedulerClock::Notified(condition_);
     condition_.notify_one();
 }
 
@@ -60,7 +61,9 @@ std::cv_status ThreadCondition::WaitFor(const timeout_msecs &timeout) {
     if (timeout == TIMEOUT_NEVER) {
         while (!flag_.load()) {
             std::unique_lock<std::mutex> lock(mutex_);
-            condition_.wait(lock);
+            if (flag_.load()) break;
+
+            SchedulerClock::Wait(condition_, lock);
         }
     } else {
         //  A thread uses a timeout when it wants to sleep for a finite
@@ -72,20 +75,25 @@ std::cv_status ThreadCondition::WaitFor(const timeout_msecs &timeout) {
         //  with a heartbeat or to wake up a thread and request that it
         //  immediately exit when a restart is initiated.
         //
-        auto deadline = std::chrono::steady_clock::now() + timeout;
+        //  The wait itself is delegated to SchedulerClock so that under the
+        //  simulated clock virtual time is advanced instead of sleeping.  As
+        //  that can return early, flag_ is checked again with the mutex held
+        //  so a Notify() is never missed.
+        //
+        auto deadline = SchedulerClock::Now() + timeout;
 
         while (!flag_.load()) {
             std::unique_lock<std::mutex> lock(mutex_);
-            auto sleep = deadline - std::chrono::steady_clock::now();
+            if (flag_.load()) break;
 
-            if (sleep.count() <= 0) {
+            if (SchedulerClock::Now() >= deadline) {
                 result = std::cv_status::timeout;
                 break;
             }
 
-            result = condition_.wait_for(lock, sleep);
+            result = SchedulerClock::WaitUntil(condition_, lock, deadline);
 
-            if (std::chrono::steady_clock::now() > deadline) break;
+            if (SchedulerClock::Now() > deadline) break;
         }
     }
 
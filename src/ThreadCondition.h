@@ -28,6 +28,7 @@ Acknowledgement:
 #include <atomic>
 #include <condition_variable>   // NOLINT
 #include <mutex>                // NOLINT
+#include "SchedulerClock.h"
 
 namespace sprocketRealtimeScheduler {
 
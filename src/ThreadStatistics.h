@@ -103,6 +103,55 @@ struct ThreadStartTimeJitterEntryData {
     double best_start_jitter_;
 };
 
+// Response time data (event arrival to handler completion) for events
+// serviced by an event server during a single frame.
+struct EventResponseEntry {
+    // Current response time.
+    double current_response_;
+
+    // The average response time.
+    double average_response_;
+
+    // The best response time.
+    double best_response_;
+
+    // The worst response time.
+    double worst_response_;
+
+    // Total accumulated response times.
+    double total_response_;
+
+    // Total count of events serviced.
+    unsigned int total_events_serviced_;
+};
+
+struct EventResponseEntryData {
+    EventResponseEntry data_;
+    double worst_response_time_;
+    double best_response_time_;
+    unsigned int budget_exhausted_count_;
+    unsigned int events_dropped_;
+    double worst_overrun_;
+    double budget_debt_;
+};
+
+struct EventServerStatistics {
+    EventResponseEntry response_data_[MAX_FRAMES];
+
+    // The worst response time of any event to date.
+    double worst_response_time_;
+
+    // The best response time of any event to date.
+    double best_response_time_;
+
+    // Number of major frames in which the budget ran out with events still
+    // waiting to be serviced.
+    unsigned int budget_exhausted_count_;
+
+    // The largest amount a handler has overrun the remaining budget by.
+    double worst_overrun_;
+};
+
 struct ThreadStatistics {
     // ===========================
     // = Frame Timing Statistics =